@@ -42,7 +42,8 @@ namespace cepgen {
       std::pair<std::vector<double>, double> generateEvent() override { return std::make_pair(coords_, 1.); }
       std::pair<double, double> getIntegral() override { return std::make_pair(1., 1.); }
 
-      void setCoordinates(const std::vector<double>&);
+      /// Set the physical coordinates (kinematic, then radiative corrections variables) of the next event
+      void setCoordinates(const std::vector<double>& coords) { coords_ = coords; }
       const std::vector<Limits>& ranges() const { return ranges_; }
 
     private:
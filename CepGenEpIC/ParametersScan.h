@@ -0,0 +1,60 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2024  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEpIC_ParametersScan_h
+#define CepGenEpIC_ParametersScan_h
+
+#include <CepGen/Core/SteeredObject.h>
+
+#include <string>
+#include <vector>
+
+namespace cepgen {
+  namespace epic {
+    class ProcessInterface;
+    /// Scan of cross sections over a grid of experimental conditions/kinematic ranges settings
+    class ParametersScan : public SteeredObject<ParametersScan> {
+    public:
+      explicit ParametersScan(const ParametersList&);
+
+      static ParametersDescription description();
+
+      bool empty() const { return axes_.empty(); }
+      /// Compute the cross section at all scan points, reusing an already initialised EpIC process
+      void run(const ParametersList& process_params, ProcessInterface&) const;
+
+    private:
+      /// One scanned parameter of a task
+      struct Axis {
+        explicit Axis(const ParametersList&);
+        std::string name() const;
+        void apply(ParametersList& task, double value) const;
+
+        const std::string block, parameter, bound;
+        const std::vector<double> values;
+      };
+      std::vector<std::vector<double> > points() const;
+
+      std::vector<Axis> axes_;
+      const ParametersList integrator_params_;
+      const std::string filename_;
+    };
+  }  // namespace epic
+}  // namespace cepgen
+
+#endif
@@ -24,19 +24,64 @@
 #include <automation/MonteCarloTask.h>
 #include <services/GeneratorService.h>
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "CepGenEpIC/EventGenerator.h"
+#include "CepGenEpIC/WeightsTable.h"
 #include "CepGenEpIC/Writer.h"
 
 namespace cepgen {
   namespace epic {
     class ProcessInterface {
     public:
+      /// Phase space mapping of a radiative corrections variable from the unit hypercube
+      enum class Mapping { linear, exponential, square };
+
       ProcessInterface() {}
-      virtual const std::vector<Limits> ranges() const = 0;
+      /// Initialise the EpIC instance and build the interface to the scenario steered by the process parameters
+      static std::unique_ptr<ProcessInterface> build(const ParametersList&);
+      virtual ~ProcessInterface() {
+        if (weights_)
+          weights_->merge(stats_);
+      }
+      virtual const std::vector<Limits>& ranges() const = 0;
+      /// Physical ranges of the additional radiative corrections variables
+      virtual const std::vector<Limits>& rcRanges() const = 0;
       virtual size_t ndim() const = 0;
-      virtual double generate(const std::vector<double>&, Event&) const = 0;
+      /// Weight of a unit-hypercube point, including the jacobian of its mapping onto physical coordinates
+      double weight(const std::vector<double>&);
+      /// Compute the weight of a phase space point, to be used for event generation
+      virtual double generate(const std::vector<double>&) = 0;
+      /// Build the event content for the last phase space point generated
+      virtual void fillEvent(Event&) = 0;
+      /// Update the experimental conditions and kinematic ranges of an already initialised task
+      virtual void update(const EPIC::MonteCarloTask&) = 0;
+
+      /// Set the phase space mapping (linear/exponential/square) of each radiative corrections variable
+      /// \note Unset mappings are exponential for strictly positive ranges, linear otherwise
+      void setRCMappings(const std::vector<std::string>&);
+      /// Enable the local unweighting of events against a cell-local maximum weights table
+      void setWeightsTable(const ParametersList&, const std::string& channel, const std::string& scenario);
+
+    protected:
+      /// Guard for the EpIC services, shared by all process instances
+      static std::mutex& serviceMutex();
+      /// Map a unit-hypercube point onto the physical coordinates of the EpIC generator service
+      /// \return jacobian of the transformation
+      double map(const std::vector<double>& coords, std::vector<double>& phys_coords) const;
+      /// Event distribution at a point given in physical coordinates
+      virtual double distribution(std::vector<double>& phys_coords) = 0;
+      /// Resolve the radiative corrections variables mappings for the current ranges
+      void resolveRCMappings();
+
+      std::shared_ptr<WeightsTable> weights_;
+      WeightsTable::Statistics stats_;  ///< unweighting statistics for this process clone
+
+    private:
+      std::vector<std::string> rc_mappings_names_;
+      std::vector<Mapping> rc_mappings_;
     };
 
     template <typename T>
@@ -49,6 +94,12 @@ namespace cepgen {
               new TH1D(Form("h_%zu", T::m_histograms.size()), "", 100, range.min(), range.max()));
       }
       void bookHistograms() override {}
+      /// Re-read the experimental conditions and kinematic ranges without rebuilding the modules tree
+      void updateConditions(const EPIC::MonteCarloTask& task) {
+        T::getExperimentalConditionsFromTask(task);
+        T::getKinematicRangesFromTask(task);
+        T::initialise();
+      }
     };
 
     /// Interface to an EpIC generator service
@@ -65,34 +116,79 @@ namespace cepgen {
         if (!service_)
           throw CG_FATAL("ProcessServiceInterface")
               << "Failed to interface the EPIC generator service to build a CepGen-compatible process definition.";
+        std::lock_guard<std::mutex> lock(serviceMutex());
         service_->setScenarioDescription(scenario.getDescription());
         service_->setScenarioDate(scenario.getDate());
         service_->computeTask(task);
         if (!service_->getKinematicModule()->runTest())
           CG_WARNING("ProcessServiceInterface") << "Kinematic module test failed.";
         evt_gen_ = dynamic_cast<EventGenerator*>(service_->getEventGeneratorModule().get());
-        ranges_ = evt_gen_->ranges();
-        service_->setRanges(ranges_);
+        setRanges();
         writer_ = dynamic_cast<Writer*>(service_->getWriterModule().get());
+        resolveRCMappings();
         CG_INFO("ProcessServiceInterface") << "Process service interface initialised for dimension-" << ndim() << " '"
                                            << service_->getClassName() << "' process.\n"
-                                           << "\tKinematic ranges: " << ranges_ << ".";
+                                           << "\tKinematic ranges: " << ranges_ << ",\n"
+                                           << "\tRadiative corrections ranges: " << rc_ranges_ << ".";
         auto general_params = service_->getGeneralConfiguration();
         general_params.setNEvents(1);
         service_->setGeneralConfiguration(general_params);
       }
-      const std::vector<Limits> ranges() const override { return ranges_; }
-      size_t ndim() const override { return ranges_.size(); }
-      double generate(const std::vector<double>& coords, Event& event) const override {
-        evt_gen_->setCoordinates(coords);
+      const std::vector<Limits>& ranges() const override { return ranges_; }
+      const std::vector<Limits>& rcRanges() const override { return rc_ranges_; }
+      size_t ndim() const override { return ranges_.size() + rc_ranges_.size(); }
+      double generate(const std::vector<double>& coords) override {
+        last_coords_ = coords;
+        last_jacobian_ = 1.;
+        if (weights_)  // sample each dimension according to its local maximum weights
+          last_jacobian_ = weights_->map(last_coords_);
+        const auto jacobian = map(last_coords_, last_phys_coords_);
+        last_weight_ = distribution(last_phys_coords_) * jacobian;
+        return last_weight_ * last_jacobian_;
+      }
+      void fillEvent(Event& event) override {
+        if (weights_) {  // only points for which an event is requested are accounted for
+          const auto weight = last_weight_ * last_jacobian_;
+          ++stats_.num_evaluated;
+          stats_.sum_weights += weight;
+          stats_.max_weight = std::max(stats_.max_weight, weight);
+          if (last_weight_ > weights_->localMaximum(last_coords_))
+            ++stats_.num_overweight;
+        }
+        evt_gen_->setCoordinates(last_phys_coords_);
         service_->run();
         event = writer_->event();
-        return service_->getEventDistribution(const_cast<std::vector<double>&>(coords));
+      }
+      void update(const EPIC::MonteCarloTask& task) override {
+        std::lock_guard<std::mutex> lock(serviceMutex());
+        service_->updateConditions(task);
+        setRanges();
+        resolveRCMappings();
+      }
+
+    protected:
+      /// EpIC event distributions are evaluated at the coordinates returned by the event generator module,
+      /// i.e. kinematic variables within the generator ranges, followed by the radiative corrections variables
+      /// within the RC module ranges
+      double distribution(std::vector<double>& phys_coords) override {
+        return service_->getEventDistribution(phys_coords);
       }
 
     private:
+      void setRanges() {
+        ranges_ = evt_gen_->ranges();
+        rc_ranges_.clear();
+        for (const auto& range : service_->getRCModule()->getVariableRanges())  // RC variables sampled by CepGen
+          rc_ranges_.emplace_back(Limits{range.getMin(), range.getMax()});
+        auto all_ranges = ranges_;
+        all_ranges.insert(all_ranges.end(), rc_ranges_.begin(), rc_ranges_.end());
+        service_->setRanges(all_ranges);
+      }
+
       ProcessServiceWrapper<T>* service_{nullptr};
-      std::vector<Limits> ranges_;
+      std::vector<Limits> ranges_, rc_ranges_;
+      std::vector<double> last_coords_, last_phys_coords_;
+      double last_weight_{0.}, last_jacobian_{1.};
       const RangeTransformation set_ranges_transform_{nullptr};
       EventGenerator* evt_gen_{nullptr};
       Writer* writer_{nullptr};
@@ -0,0 +1,90 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2024  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEpIC_WeightsTable_h
+#define CepGenEpIC_WeightsTable_h
+
+#include <CepGen/Core/SteeredObject.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cepgen {
+  namespace epic {
+    /// Table of cell-local maximum weights for the unweighting of EpIC events
+    /// \note The maxima are projected onto each dimension to build a separable sampling density, so that the
+    ///   integrand seen by the CepGen integrator and events generator is flattened while keeping the VEGAS grids'
+    ///   meaning for each dimension
+    class WeightsTable : public SteeredObject<WeightsTable> {
+    public:
+      explicit WeightsTable(const ParametersList&);
+      ~WeightsTable();
+
+      static ParametersDescription description();
+
+      using Integrand = std::function<double(const std::vector<double>&)>;
+      /// Retrieve the table shared by all clones of a process for a given channel, building it on first call
+      /// \param[in] ndim number of unit-hypercube dimensions to bin
+      /// \param[in] scenario digest of the task conditions the table is built for
+      /// \param[in] integrand weight of a ndim-dimensional point, used to fill the table during warmup
+      static std::shared_ptr<WeightsTable> get(const ParametersList&,
+                                               size_t ndim,
+                                               const std::string& channel,
+                                               const std::string& scenario,
+                                               const Integrand& integrand);
+
+      /// Move a point of the unit hypercube according to the local maximum weights in each dimension
+      /// \return jacobian of the transformation
+      double map(std::vector<double>& coords) const;
+      /// Maximum weight recorded during warmup in the cell holding a point
+      double localMaximum(const std::vector<double>& coords) const { return max_weights_.at(cell(coords)); }
+
+      /// Unweighting statistics of a process clone, merged into the table at the end of its run
+      struct Statistics {
+        size_t num_evaluated{0}, num_overweight{0};
+        double sum_weights{0.}, max_weight{0.};
+      };
+      void merge(const Statistics&);
+
+    private:
+      void initialise(size_t ndim, const std::string& channel, const std::string& scenario, const Integrand&);
+      size_t cell(const std::vector<double>&) const;
+      void warmup(const Integrand&);
+      bool load();
+      void save() const;
+
+      const size_t num_bins_;
+      const size_t warmup_points_;
+      const std::string filename_;
+      const unsigned long long seed_;
+
+      std::string channel_, digest_;
+      size_t ndim_{0};
+      std::vector<double> max_weights_;
+      std::vector<std::vector<double> > cumulative_;  ///< cumulative sampling density for each dimension
+
+      std::mutex mutex_;
+      Statistics stats_;
+    };
+  }  // namespace epic
+}  // namespace cepgen
+
+#endif
@@ -0,0 +1,56 @@
+# cross sections scan, to be run with: cepgenEpICScan -i epic_dvcs_scan_cfg.py
+import Config.Core as cepgen
+from Config.PDG_cfi import PDG
+from Integrators.miser_cfi import miser as integrator
+from math import pi
+
+
+process = cepgen.Module('epic',
+    date = '2017-07-18',
+    description = 'Scan of DVCS cross sections',
+    tasks = [
+        cepgen.Module('DVCSGeneratorService',
+            kinematic_range = cepgen.Parameters(
+                range_y = (0.05, 0.95),
+                range_Q2 = (1., 10.),
+                range_t = (-1., -1.e-4),
+                range_phi = (0.05, 2. * pi - 0.05),
+                range_phiS = (0., 2. * pi),
+                range_xB = (1.e-6, 1.),
+            ),
+            experimental_conditions = cepgen.Parameters(
+                lepton_energy = 100.,
+                lepton_type = 'e-',
+                lepton_helicity = -1,
+                hadron_energy = '1.00001*Mp',
+                hadron_type = 'p',
+                hadron_polarisation = [0., 0., 0.]
+            ),
+            computation_configuration = cepgen.Parameters(
+                DVCSProcessModule = cepgen.Module('DVCSProcessGV08',
+                    DVCSScalesModule = cepgen.Module('DVCSScalesQ2Multiplier',
+                        Lambda = 1.,
+                    ),
+                    DVCSXiConverterModule = cepgen.Module('DVCSXiConverterXBToXi'),
+                    DVCSConvolCoeffFunctionModule = cepgen.Module('DVCSCFFCMILOU3DTables',
+                        qcd_order_type = 'LO',
+                    ),
+                ),
+            ),
+            kinematic_configuration = cepgen.Parameters(
+                DVCSKinematicModule = cepgen.Module('DVCSKinematicDefault'),
+            ),
+            rc_configuration = cepgen.Parameters(
+                DVCSRCModule = cepgen.Module('DVCSRCNull'),
+            ),
+        ),
+    ],
+    scan = cepgen.Parameters(
+        axes = [
+            cepgen.Parameters(parameter = 'lepton_energy', values = [5., 10., 18.]),
+            cepgen.Parameters(block = 'kinematic_range', parameter = 'range_Q2', bound = 'max', values = [5., 10., 20.]),
+        ],
+        integrator = integrator,
+        output = 'epic_dvcs_scan.txt',
+    ),
+)
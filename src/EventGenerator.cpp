@@ -46,10 +46,5 @@ namespace cepgen {
                                       << "f(" << coords_ << ") = " << gen_interface.getEventDistribution(coords_)
                                       << ".";
     }
-
-    void EventGenerator::setCoordinates(const std::vector<double>& coords) {
-      for (size_t i = 0; i < ranges_.size(); ++i)
-        coords_[i] = ranges_.at(i).x(coords.at(i));
-    }
   }  // namespace epic
 }  // namespace cepgen
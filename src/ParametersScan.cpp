@@ -0,0 +1,145 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2024  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Core/Exception.h>
+#include <CepGen/Integration/FunctionIntegrand.h>
+#include <CepGen/Integration/Integrator.h>
+#include <CepGen/Modules/IntegratorFactory.h>
+#include <CepGen/Utils/Limits.h>
+#include <CepGen/Utils/Message.h>
+#include <CepGen/Utils/String.h>
+#include <CepGen/Utils/Timer.h>
+
+#include <fstream>
+
+#include "CepGenEpIC/ParametersScan.h"
+#include "CepGenEpIC/ProcessInterface.h"
+#include "CepGenEpIC/ScenarioParser.h"
+
+using namespace std::string_literals;
+
+namespace cepgen {
+  namespace epic {
+    ParametersScan::ParametersScan(const ParametersList& params)
+        : SteeredObject(params),
+          integrator_params_(steer<ParametersList>("integrator")),
+          filename_(steer<std::string>("output")) {
+      for (const auto& axis : steer<std::vector<ParametersList> >("axes"))
+        axes_.emplace_back(axis);
+    }
+
+    void ParametersScan::run(const ParametersList& process_params, ProcessInterface& proc) const {
+      auto integrator = IntegratorFactory::get().build(integrator_params_);
+      std::ofstream output(filename_);
+      output << "#";
+      for (const auto& axis : axes_)
+        output << axis.name() << "\t";
+      output << "xsec (pb)\tunc (pb)\ttime (s)\n";
+      utils::Timer tmr_total;
+      const auto scan_points = points();
+      for (const auto& point : scan_points) {
+        auto params = process_params;
+        for (auto& task : params.operator[]<std::vector<ParametersList> >("tasks"))
+          for (size_t i = 0; i < axes_.size(); ++i)
+            axes_.at(i).apply(task, point.at(i));
+        utils::Timer tmr;
+        proc.update(ScenarioParser(params).getTasks().back());
+        // same unit-hypercube mapping (incl. radiative corrections variables) as for the nominal integration
+        FunctionIntegrand integrand(proc.ndim(), [&proc](const std::vector<double>& coords) {
+          return proc.weight(coords);
+        });
+        const auto xsec = integrator->integrate(integrand);
+        const auto time = tmr.elapsed();
+        for (const auto& val : point)
+          output << val << "\t";
+        output << xsec.value() << "\t" << xsec.uncertainty() << "\t" << time << "\n";
+        CG_INFO("epic:ParametersScan") << "Scan point " << point << ": xsec = " << xsec << " (" << time << " s).";
+      }
+      proc.update(ScenarioParser(process_params).getTasks().back());  // restore the nominal conditions
+      CG_INFO("epic:ParametersScan") << "Scan over " << scan_points.size() << " point(s) completed in "
+                                     << tmr_total.elapsed() << " s. Results stored in '" << filename_ << "'.";
+    }
+
+    std::vector<std::vector<double> > ParametersScan::points() const {
+      std::vector<std::vector<double> > points{{}};
+      for (const auto& axis : axes_) {  // cartesian product of all axes values
+        std::vector<std::vector<double> > new_points;
+        for (const auto& point : points)
+          for (const auto& value : axis.values) {
+            new_points.emplace_back(point);
+            new_points.back().emplace_back(value);
+          }
+        points = new_points;
+      }
+      return points;
+    }
+
+    ParametersScan::Axis::Axis(const ParametersList& params)
+        : block(params.get<std::string>("block")),
+          parameter(params.get<std::string>("parameter")),
+          bound(params.get<std::string>("bound")),
+          values(params.get<std::vector<double> >("values")) {
+      if (parameter.empty() || values.empty())
+        throw CG_FATAL("epic:ParametersScan") << "Invalid scan axis: " << params << ".";
+      if (!bound.empty() && bound != "min" && bound != "max")
+        throw CG_FATAL("epic:ParametersScan") << "Invalid range bound for '" << parameter << "' scan axis: '" << bound
+                                              << "'. Should be either 'min' or 'max'.";
+    }
+
+    std::string ParametersScan::Axis::name() const {
+      return block + "/" + parameter + (bound.empty() ? "" : "/" + bound);
+    }
+
+    void ParametersScan::Axis::apply(ParametersList& task, double value) const {
+      if (!task.has<ParametersList>(block))
+        throw CG_FATAL("epic:ParametersScan") << "Block '" << block << "' is not defined in the task.";
+      auto& task_block = task.operator[]<ParametersList>(block);
+      if (bound.empty()) {  // scalar parameter, possibly steered as a string expression (e.g. '1.00001*Mp')
+        if (!task_block.has<double>(parameter) && !task_block.has<int>(parameter) &&
+            !task_block.has<std::string>(parameter))
+          throw CG_FATAL("epic:ParametersScan") << "Parameter '" << parameter << "' is not defined in '" << block
+                                                << "' block.";
+        task_block.erase(parameter);
+        task_block.set<double>(parameter, value);
+        return;
+      }
+      if (!task_block.has<Limits>(parameter))
+        throw CG_FATAL("epic:ParametersScan") << "Range '" << parameter << "' is not defined in '" << block
+                                              << "' block.";
+      auto range = task_block.get<Limits>(parameter);
+      (bound == "min" ? range.min() : range.max()) = value;
+      task_block.set<Limits>(parameter, range);
+    }
+
+    ParametersDescription ParametersScan::description() {
+      auto desc = ParametersDescription();
+      desc.setDescription("Cross section scan over task parameters");
+
+      auto axis_desc = ParametersDescription();
+      axis_desc.add("block", "experimental_conditions"s).setDescription("task block holding the parameter");
+      axis_desc.add("parameter", ""s).setDescription("name of the scanned parameter");
+      axis_desc.add("bound", ""s).setDescription("range bound to scan ('min' or 'max') for a range parameter");
+      axis_desc.add("values", std::vector<double>{}).setDescription("list of values to scan");
+      desc.addParametersDescriptionVector("axes", axis_desc);
+
+      desc.add("integrator", ParametersDescription().setName("Vegas")).setDescription("integrator for each point");
+      desc.add("output", "epic_scan.txt"s).setDescription("path to the output cross sections table");
+      return desc;
+    }
+  }  // namespace epic
+}  // namespace cepgen
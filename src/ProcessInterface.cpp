@@ -0,0 +1,206 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2024  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Utils/Filesystem.h>
+#include <CepGen/Utils/Message.h>
+#include <CepGen/Utils/String.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+// EpIC includes
+#include <Epic.h>
+#include <managers/RandomSeedManager.h>
+#include <managers/ServiceObjectRegistry.h>
+#include <services/DDVCSGeneratorService.h>
+#include <services/DVCSGeneratorService.h>
+#include <services/DVMPGeneratorService.h>
+#include <services/GAM2GeneratorService.h>
+#include <services/TCSGeneratorService.h>
+
+#include "CepGenEpIC/ProcessInterface.h"
+#include "CepGenEpIC/ScenarioParser.h"
+
+namespace cepgen {
+  namespace epic {
+    static std::vector<char*> parseArguments(unsigned long long seed) {
+      const auto args = std::vector<std::string>{
+          fs::current_path() / "data" / "partons.properties", utils::format("--seed=%zu", seed), "--scenario=''"};
+      CG_DEBUG("epic:ProcessInterface:parseArguments") << "List of arguments handled:\n\t" << args << ".";
+      std::vector<char*> argv;
+      std::transform(args.begin(), args.end(), std::back_inserter(argv), [](const std::string& str) -> char* {
+        char* out = new char[str.size() + 1];
+        std::strcpy(out, str.data());
+        return out;
+      });
+      return argv;
+    }
+
+    std::unique_ptr<ProcessInterface> ProcessInterface::build(const ParametersList& params) {
+      // initialise the EpIC instance
+      const auto seed = params.get<unsigned long long>("seed");
+      auto args = parseArguments(seed);
+      auto* epic = EPIC::Epic::getInstance();
+      epic->init(args.size(), args.data());
+      epic->getRandomSeedManager()->setSeedCount(seed);
+      const auto scenario = ScenarioParser(params);
+      std::unique_ptr<ProcessInterface> proc;
+      for (auto& task : scenario.getTasks()) {
+        const auto& name = task.getServiceName();
+        if (name == "DVCSGeneratorService")
+          proc.reset(new ProcessServiceInterface(
+              epic->getServiceObjectRegistry()->getDVCSGeneratorService(), scenario, task, [](auto& ranges) {
+                ranges.at(0).setMinMax(log(ranges.at(0).getMin()), log(ranges.at(0).getMax()));
+                ranges.at(1).setMinMax(log(ranges.at(1).getMin()), log(ranges.at(1).getMax()));
+                ranges.at(2).setMinMax(log(-1 * ranges.at(2).getMax()), log(-1 * ranges.at(2).getMin()));
+              }));
+        else if (name == "TCSGeneratorService")
+          proc.reset(new ProcessServiceInterface(
+              epic->getServiceObjectRegistry()->getTCSGeneratorService(), scenario, task, [](auto& ranges) {
+                ranges.at(0).setMinMax(log(-1 * ranges.at(0).getMax()), log(-1 * ranges.at(0).getMin()));
+                ranges.at(1).setMinMax(log(ranges.at(1).getMin()), log(ranges.at(1).getMax()));
+                ranges.at(5).setMinMax(log(ranges.at(5).getMin()), log(ranges.at(5).getMax()));
+                ranges.at(6).setMinMax(log(ranges.at(6).getMin()), log(ranges.at(6).getMax()));
+              }));
+        else if (name == "DVMPGeneratorService")
+          proc.reset(new ProcessServiceInterface(
+              epic->getServiceObjectRegistry()->getDVMPGeneratorService(), scenario, task, [](auto& ranges) {
+                ranges.at(0).setMinMax(log(ranges.at(0).getMin()), log(ranges.at(0).getMax()));
+                ranges.at(1).setMinMax(log(ranges.at(1).getMin()), log(ranges.at(1).getMax()));
+                ranges.at(2).setMinMax(log(-1 * ranges.at(2).getMax()), log(-1 * ranges.at(2).getMin()));
+              }));
+        else if (name == "GAM2GeneratorService")
+          proc.reset(new ProcessServiceInterface(
+              epic->getServiceObjectRegistry()->getGAM2GeneratorService(), scenario, task, [](auto& ranges) {
+                ranges.at(0).setMinMax(log(-1 * ranges.at(0).getMax()), log(-1 * ranges.at(0).getMin()));
+                ranges.at(2).setMinMax(log(ranges.at(2).getMin()), log(ranges.at(2).getMax()));
+                ranges.at(4).setMinMax(log(ranges.at(4).getMin()), log(ranges.at(4).getMax()));
+                ranges.at(5).setMinMax(log(ranges.at(5).getMin()), log(ranges.at(5).getMax()));
+              }));
+        else if (name == "DDVCSGeneratorService")
+          proc.reset(new ProcessServiceInterface(
+              epic->getServiceObjectRegistry()->getDDVCSGeneratorService(), scenario, task, [](auto& ranges) {
+                ranges.at(0).setMinMax(log(ranges.at(0).getMin()), log(ranges.at(0).getMax()));
+                ranges.at(1).setMinMax(log(ranges.at(1).getMin()), log(ranges.at(1).getMax()));
+                ranges.at(2).setMinMax(log(-1 * ranges.at(2).getMax()), log(-1 * ranges.at(2).getMin()));
+                ranges.at(3).setMinMax(log(ranges.at(3).getMin()), log(ranges.at(3).getMax()));
+              }));
+        else
+          throw CG_FATAL("epic:ProcessInterface:build") << "Unsupported EpIC service: '" << name << "'.";
+        CG_INFO("epic:ProcessInterface:build") << "New '" << name << "' task built.";
+        proc->setRCMappings(params.get<std::vector<std::string> >("rc_mappings"));
+        if (const auto unweighting = params.get<ParametersList>("unweighting"); unweighting.get<bool>("enabled"))
+          proc->setWeightsTable(
+              unweighting, name, task.getExperimentalConditions().toString() + task.getKinematicRange().toString());
+      }
+      if (!proc)
+        throw CG_FATAL("epic:ProcessInterface:build") << "No EpIC task could be built from the scenario.";
+      return proc;
+    }
+
+    std::mutex& ProcessInterface::serviceMutex() {
+      static std::mutex mutex;
+      return mutex;
+    }
+
+    double ProcessInterface::weight(const std::vector<double>& coords) {
+      std::vector<double> phys_coords;
+      const auto jacobian = map(coords, phys_coords);
+      return distribution(phys_coords) * jacobian;
+    }
+
+    void ProcessInterface::setRCMappings(const std::vector<std::string>& mappings) {
+      rc_mappings_names_ = mappings;
+      resolveRCMappings();
+    }
+
+    void ProcessInterface::resolveRCMappings() {
+      const auto& rc_ranges = rcRanges();
+      rc_mappings_.clear();
+      for (size_t i = 0; i < rc_ranges.size(); ++i) {
+        const auto& range = rc_ranges.at(i);
+        if (i >= rc_mappings_names_.size()) {  // logarithmic sampling of soft/collinear peaks whenever possible
+          rc_mappings_.emplace_back(range.min() > 0. ? Mapping::exponential : Mapping::linear);
+          continue;
+        }
+        const auto& name = rc_mappings_names_.at(i);
+        if (name == "linear")
+          rc_mappings_.emplace_back(Mapping::linear);
+        else if (name == "exponential") {
+          if (range.min() <= 0.)
+            throw CG_FATAL("epic:ProcessInterface")
+                << "Exponential mapping requires a strictly positive range for radiative corrections variable #" << i
+                << ", got " << range << ". A positive IR cutoff is required.";
+          rc_mappings_.emplace_back(Mapping::exponential);
+        } else if (name == "square") {
+          if (range.min() < 0.)
+            throw CG_FATAL("epic:ProcessInterface")
+                << "Square mapping requires a positive range for radiative corrections variable #" << i << ", got "
+                << range << ".";
+          rc_mappings_.emplace_back(Mapping::square);
+        } else
+          throw CG_FATAL("epic:ProcessInterface") << "Invalid phase space mapping for radiative corrections variable #"
+                                                  << i << ": '" << name << "'.";
+      }
+    }
+
+    double ProcessInterface::map(const std::vector<double>& coords, std::vector<double>& phys_coords) const {
+      const auto &kin_ranges = ranges(), &rc_ranges = rcRanges();
+      phys_coords.resize(coords.size());
+      double jacobian = 1.;
+      for (size_t i = 0; i < kin_ranges.size(); ++i) {
+        phys_coords[i] = kin_ranges.at(i).x(coords.at(i));
+        jacobian *= kin_ranges.at(i).range();
+      }
+      for (size_t i = 0, j = kin_ranges.size(); i < rc_ranges.size(); ++i, ++j) {
+        const auto& range = rc_ranges.at(i);
+        switch (rc_mappings_.at(i)) {
+          case Mapping::linear: {
+            phys_coords[j] = range.x(coords.at(j));
+            jacobian *= range.range();
+          } break;
+          case Mapping::exponential: {
+            const auto log_ratio = std::log(range.max() / range.min());
+            phys_coords[j] = range.min() * std::exp(coords.at(j) * log_ratio);
+            jacobian *= phys_coords[j] * log_ratio;
+          } break;
+          case Mapping::square: {
+            const auto sqrt_min = std::sqrt(range.min()), sqrt_range = std::sqrt(range.max()) - sqrt_min;
+            const auto sqrt_val = sqrt_min + coords.at(j) * sqrt_range;
+            phys_coords[j] = sqrt_val * sqrt_val;
+            jacobian *= 2. * sqrt_val * sqrt_range;
+          } break;
+        }
+      }
+      return jacobian;
+    }
+
+    void ProcessInterface::setWeightsTable(const ParametersList& params,
+                                           const std::string& channel,
+                                           const std::string& scenario) {
+      weights_ = WeightsTable::get(
+          params, ranges().size(), channel, scenario, [this](const std::vector<double>& kin_coords) {
+            auto coords = kin_coords;
+            coords.resize(ndim(), 0.5);  // radiative corrections variables are probed at their mapped midpoint
+            return weight(coords);
+          });
+    }
+  }  // namespace epic
+}  // namespace cepgen
@@ -0,0 +1,217 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2024  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Core/Exception.h>
+#include <CepGen/Utils/Filesystem.h>
+#include <CepGen/Utils/Message.h>
+#include <CepGen/Utils/String.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <random>
+
+#include "CepGenEpIC/WeightsTable.h"
+
+using namespace std::string_literals;
+
+namespace cepgen {
+  namespace epic {
+    static size_t positive(int value, const std::string& name) {
+      if (value < 1)
+        throw CG_FATAL("epic:WeightsTable") << "Invalid '" << name << "' parameter: " << value
+                                            << ". Should be strictly positive.";
+      return static_cast<size_t>(value);
+    }
+
+    /// 64-bit FNV-1a digest, stable across runs and platforms
+    static std::string digest(const std::string& str) {
+      unsigned long long hash = 14695981039346656037ull;
+      for (const auto& chr : str)
+        hash = (hash ^ static_cast<unsigned char>(chr)) * 1099511628211ull;
+      return utils::format("%016llx", hash);
+    }
+
+    WeightsTable::WeightsTable(const ParametersList& params)
+        : SteeredObject(params),
+          num_bins_(positive(steer<int>("num_bins"), "num_bins")),
+          warmup_points_(positive(steer<int>("warmup_points"), "warmup_points")),
+          filename_(steer<std::string>("file")),
+          seed_(steer<unsigned long long>("seed")) {}
+
+    WeightsTable::~WeightsTable() {
+      if (stats_.num_evaluated == 0)
+        return;
+      CG_INFO("epic:WeightsTable") << "Unweighting summary for '" << channel_ << "' channel over "
+                                   << stats_.num_evaluated << " non-zero weight generation trial(s):\n\t"
+                                   << "efficiency against the largest weight: "
+                                   << 100. * stats_.sum_weights / stats_.num_evaluated / stats_.max_weight << "%,\n\t"
+                                   << stats_.num_overweight << " point(s) above their cell maximum, fraction: "
+                                   << 100. * stats_.num_overweight / stats_.num_evaluated << "%.";
+    }
+
+    std::shared_ptr<WeightsTable> WeightsTable::get(const ParametersList& params,
+                                                    size_t ndim,
+                                                    const std::string& channel,
+                                                    const std::string& scenario,
+                                                    const Integrand& integrand) {
+      // one table per channel and scenario, built (or loaded) once, then shared read-only by all process clones
+      static std::mutex mutex;
+      static std::map<std::string, std::weak_ptr<WeightsTable> > tables;
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto key = channel + ":" + digest(scenario);
+      if (auto table = tables[key].lock())
+        return table;
+      auto table = std::make_shared<WeightsTable>(params);
+      table->initialise(ndim, channel, scenario, integrand);
+      tables[key] = table;
+      return table;
+    }
+
+    void WeightsTable::initialise(size_t ndim,
+                                  const std::string& channel,
+                                  const std::string& scenario,
+                                  const Integrand& integrand) {
+      ndim_ = ndim;
+      channel_ = channel;
+      digest_ = digest(scenario);
+      const auto num_cells = std::pow(num_bins_, ndim_);
+      if (num_cells > 1.e7)
+        throw CG_FATAL("epic:WeightsTable") << "Too many cells (" << num_cells << ") for a " << ndim_
+                                            << "-dimensional table with " << num_bins_ << " bins per dimension.";
+      max_weights_.assign(static_cast<size_t>(num_cells), 0.);
+      if (filename_.empty() || !load()) {
+        warmup(integrand);
+        if (!filename_.empty())
+          save();
+      }
+      // project the local maxima onto each dimension to build a separable sampling density
+      cumulative_.assign(ndim_, std::vector<double>(num_bins_, 0.));
+      for (size_t cell = 0; cell < max_weights_.size(); ++cell)
+        for (size_t i = 0, idx = cell; i < ndim_; ++i, idx /= num_bins_) {
+          auto& proj = cumulative_[i][idx % num_bins_];
+          proj = std::max(proj, max_weights_[cell]);
+        }
+      for (auto& cumul : cumulative_) {
+        // unvisited or null bins are given the smallest non-zero maximum to remain reachable
+        double min_weight = 0.;
+        for (const auto& proj : cumul)
+          if (proj > 0. && (min_weight == 0. || proj < min_weight))
+            min_weight = proj;
+        if (min_weight <= 0.)
+          throw CG_FATAL("epic:WeightsTable") << "No positive weight found in the '" << channel_ << "' channel table.";
+        for (auto& proj : cumul)
+          proj = std::max(proj, min_weight);
+        std::partial_sum(cumul.begin(), cumul.end(), cumul.begin());
+        const auto norm = cumul.back();
+        for (auto& proj : cumul)
+          proj /= norm;
+      }
+      CG_INFO("epic:WeightsTable") << "Maximum weights table prepared for '" << channel_ << "' channel with "
+                                   << max_weights_.size() << " cells.";
+    }
+
+    size_t WeightsTable::cell(const std::vector<double>& coords) const {
+      size_t cell = 0;
+      for (size_t i = ndim_; i-- > 0;)
+        cell = cell * num_bins_ + std::min(static_cast<size_t>(coords.at(i) * num_bins_), num_bins_ - 1);
+      return cell;
+    }
+
+    void WeightsTable::warmup(const Integrand& integrand) {
+      std::mt19937_64 rnd_gen(seed_);
+      std::uniform_real_distribution<double> uniform(0., 1.);
+      std::vector<double> coords(ndim_);
+      for (size_t i = 0; i < warmup_points_; ++i) {
+        for (auto& coord : coords)
+          coord = uniform(rnd_gen);
+        auto& max_weight = max_weights_[cell(coords)];
+        max_weight = std::max(max_weight, integrand(coords));
+      }
+      CG_INFO("epic:WeightsTable") << "Warmup of the local maximum weights table completed for '" << channel_
+                                   << "' channel after " << warmup_points_ << " evaluations.";
+    }
+
+    double WeightsTable::map(std::vector<double>& coords) const {
+      double jacobian = 1.;
+      for (size_t i = 0; i < ndim_; ++i) {  // each dimension is mapped independently
+        const auto& cumul = cumulative_.at(i);
+        const auto bin = std::min(
+            static_cast<size_t>(std::distance(cumul.begin(), std::upper_bound(cumul.begin(), cumul.end(), coords.at(i)))),
+            num_bins_ - 1);
+        const auto low = bin > 0 ? cumul.at(bin - 1) : 0., prob = cumul.at(bin) - low;
+        coords[i] = (bin + std::clamp((coords.at(i) - low) / prob, 0., 1.)) / num_bins_;
+        jacobian /= prob * num_bins_;
+      }
+      return jacobian;
+    }
+
+    void WeightsTable::merge(const Statistics& stats) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.num_evaluated += stats.num_evaluated;
+      stats_.num_overweight += stats.num_overweight;
+      stats_.sum_weights += stats.sum_weights;
+      stats_.max_weight = std::max(stats_.max_weight, stats.max_weight);
+    }
+
+    bool WeightsTable::load() {
+      if (!fs::exists(filename_))
+        return false;
+      std::ifstream file(filename_);
+      std::string channel, digest;
+      size_t ndim, num_bins;
+      file >> channel >> digest >> ndim >> num_bins;
+      if (channel != channel_ || digest != digest_ || ndim != ndim_ || num_bins != num_bins_) {
+        CG_WARNING("epic:WeightsTable") << "Maximum weights table stored in '" << filename_
+                                        << "' is incompatible with the current scenario (channel: " << channel
+                                        << ", conditions digest: " << digest << ", dimension: " << ndim
+                                        << ", bins: " << num_bins << "). Will rebuild it.";
+        return false;
+      }
+      for (auto& max_weight : max_weights_)
+        if (!(file >> max_weight))
+          throw CG_FATAL("epic:WeightsTable") << "Truncated maximum weights table in '" << filename_ << "'.";
+      CG_INFO("epic:WeightsTable") << "Maximum weights table for '" << channel_ << "' channel loaded from '"
+                                   << filename_ << "'.";
+      return true;
+    }
+
+    void WeightsTable::save() const {
+      std::ofstream file(filename_);
+      file.precision(17);
+      file << channel_ << " " << digest_ << " " << ndim_ << " " << num_bins_ << "\n";
+      for (const auto& max_weight : max_weights_)
+        file << max_weight << "\n";
+      CG_INFO("epic:WeightsTable") << "Maximum weights table for '" << channel_ << "' channel saved in '" << filename_
+                                   << "'.";
+    }
+
+    ParametersDescription WeightsTable::description() {
+      auto desc = ParametersDescription();
+      desc.setDescription("Cell-local maximum weights table");
+      desc.add("enabled", false).setDescription("use the local maximum weights to sample the phase space?");
+      desc.add("num_bins", 3).setDescription("number of bins per integration dimension");
+      desc.add("warmup_points", 100000).setDescription("number of weight evaluations to build the table");
+      desc.add("file", ""s).setDescription("path to the table, loaded if built for the same scenario, saved otherwise");
+      desc.add("seed", 42ull).setDescription("random seed for the warmup sampling");
+      return desc;
+    }
+  }  // namespace epic
+}  // namespace cepgen
@@ -0,0 +1,46 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2024  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Core/Exception.h>
+#include <CepGen/Core/RunParameters.h>
+#include <CepGen/Generator.h>
+#include <CepGen/Process/Process.h>
+#include <CepGen/Utils/ArgumentsParser.h>
+
+#include "CepGenEpIC/ParametersScan.h"
+#include "CepGenEpIC/ProcessInterface.h"
+
+using namespace std;
+
+/// Cross section scan over the experimental conditions/kinematic ranges of an EpIC process card,
+/// reusing a single initialised EpIC service for all points
+int main(int argc, char* argv[]) {
+  string card;
+  cepgen::ArgumentsParser(argc, argv).addArgument("config,i", "path to the configuration card", &card).parse();
+
+  cepgen::Generator gen;
+  gen.parseRunParameters(card);
+  const auto& params = gen.runParameters().process().parameters();
+  const auto scan = cepgen::epic::ParametersScan(params.get<cepgen::ParametersList>("scan"));
+  if (scan.empty())
+    throw CG_FATAL("cepgenEpICScan") << "No scan axis defined in the 'scan' block of '" << card << "'.";
+
+  auto proc = cepgen::epic::ProcessInterface::build(params);
+  scan.run(params, *proc);
+  return 0;
+}